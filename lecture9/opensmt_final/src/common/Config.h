@@ -173,6 +173,11 @@ struct Config
   // DL-Solver related parameters                                  
   int          dl_disable;                                         // Disable the solver
   int          dl_theory_propagation;                              // Enable theory propagation
+  int          dl_propagation_budget;                              // Max vertices popped per propagation search (0 = unbounded)
+  int          dl_propagation_limit;                               // Max deductions per propagation, most active atoms first (0 = unbounded)
+  int          dl_short_explanations;                              // Max edges searched for shorter conflicts and reasons (0 = disabled)
+  int          dl_model_phase;                                     // Decide atoms as in the current model (1), and suggest neighbours of asserted atoms (2)
+  int          dl_preprocess;                                      // Max searches to simplify atoms with the top level ones, and chain atoms on the same terms (0 = disabled)
   // LRA-Solver related parameters                                 
   int          lra_disable;                                        // Disable the solver
   int          lra_theory_propagation;                             // Enable theory propagation
@@ -181,6 +186,14 @@ struct Config
   int          lra_gaussian_elim;                                  // Used to switch on/off Gaussian elimination in LRA
   int          lra_integer_solver;                                 // Flag to require integer solution for LA problem
   int          lra_check_on_assert;                                // Probability (0 to 100) to run check when assert is called
+  int          lra_gomory_cuts;                                    // Enable Gomory mixed-integer cuts for the integer solver
+  int          lra_cuts_from_proofs;                               // Enable gcd-based cuts from proofs for the integer solver
+  int          lra_cut_period;                                     // Initial number of branches between two rounds of cuts
+  int          lra_float_simplex;                                  // Search the basis in floating point, certify it with exact arithmetic
+  int          lra_basis_cache;                                    // Number of feasible bases cached by bound set (0 to disable)
+  // AX-Solver related parameters                                  
+  int          ax_lazy_lemmas;                                     // Instantiate read-over-write lemmas on demand instead of in preprocessing
+  int          ax_solver;                                          // 0 for the rewriting solver, 1 for the weak equivalence one
 
   // MCMT Options go here                                          
   bool         auto_test;                                          // Auto test at the end of the search if the system is safe
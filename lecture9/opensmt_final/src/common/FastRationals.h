@@ -27,11 +27,85 @@ typedef uint64_t ulword;
 #define WORD_MIN  INT_MIN
 #define WORD_MAX  INT_MAX
 #define UWORD_MAX UINT_MAX
+#define LWORD_MAX ((lword)(~(ulword)0 >> 1))
+#define LWORD_MIN (-LWORD_MAX - 1)
 
 static inline size_t djb2(size_t a, size_t b) {
   return (a << 5) + a + b;
 }
 
+//
+// Overflow-checked 64 bits arithmetic for the
+// word representation of FastRational. Results
+// are kept in [-LWORD_MAX, LWORD_MAX], so that
+// they can always be negated safely. Return
+// true if the operation overflowed
+//
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+static inline bool lword_add_overflow(lword a, lword b, lword& r) {
+  return __builtin_add_overflow(a, b, &r) || r == LWORD_MIN;
+}
+
+static inline bool lword_sub_overflow(lword a, lword b, lword& r) {
+  return __builtin_sub_overflow(a, b, &r) || r == LWORD_MIN;
+}
+
+static inline bool lword_mul_overflow(lword a, lword b, lword& r) {
+  return __builtin_mul_overflow(a, b, &r) || r == LWORD_MIN;
+}
+#else
+static inline bool lword_add_overflow(lword a, lword b, lword& r) {
+  if ((b > 0 && a > LWORD_MAX - b) || (b < 0 && a < -LWORD_MAX - b))
+    return true;
+  r = a + b;
+  return false;
+}
+
+static inline bool lword_sub_overflow(lword a, lword b, lword& r) {
+  if ((b < 0 && a > LWORD_MAX + b) || (b > 0 && a < -LWORD_MAX + b))
+    return true;
+  r = a - b;
+  return false;
+}
+
+static inline bool lword_mul_overflow(lword a, lword b, lword& r) {
+  if (a == LWORD_MIN || b == LWORD_MIN)
+    return true;
+  ulword ua = a >= 0 ? a : -a, ub = b >= 0 ? b : -b;
+  if (ua != 0 && ub > ulword(LWORD_MAX) / ua)
+    return true;
+  r = a * b;
+  return false;
+}
+#endif
+
+//
+// Conversions between mpz and 64 bits words,
+// also where long is only 32 bits wide
+//
+static inline bool fits_lword(mpz_srcptr z) {
+  return mpz_sizeinbase(z, 2) <= 63;
+}
+
+static inline lword get_lword(mpz_srcptr z) {
+  assert(fits_lword(z));
+  if (sizeof(long) >= sizeof(lword))
+    return mpz_get_si(z);
+  ulword mag = 0;
+  mpz_export(&mag, 0, -1, sizeof(mag), 0, 0, z);
+  return mpz_sgn(z) < 0 ? -lword(mag) : lword(mag);
+}
+
+static inline void set_lword(mpz_ptr z, lword x) {
+  if (sizeof(long) >= sizeof(lword)) {
+    mpz_set_si(z, x);
+    return;
+  }
+  ulword mag = x >= 0 ? x : -x;
+  mpz_import(z, 1, -1, sizeof(mag), 0, 0, &mag);
+  if (x < 0) mpz_neg(z, z);
+}
+
 class FastInteger {
   bool has_mpz, has_word;
   word num;
@@ -268,9 +342,9 @@ public:
 
   FastRational( const mpz_class & x )
   {
-    if ( x.fits_sint_p( ) )
+    if ( fits_lword( x.get_mpz_t( ) ) )
     {
-      num = x.get_si( );
+      num = get_lword( x.get_mpz_t( ) );
       den = 1;
       has_word = true;
       has_mpq = false;
@@ -308,8 +382,8 @@ private:
       assert(has_word);
       mpq_init(mpq);
       has_mpq=true;
-      mpz_set_si(mpq_numref(mpq), num);
-      mpz_set_ui(mpq_denref(mpq), den);
+      set_lword(mpq_numref(mpq), num);
+      set_lword(mpq_denref(mpq), den);
     }
   }
 
@@ -328,16 +402,16 @@ private:
   }
   //
   // Tries to convert the current rational
-  // stored in mpq into word/uword
+  // stored in mpq into lword/ulword
   //
   void make_word()
   {
     assert( has_mpq );
-    if ( mpz_fits_sint_p(mpq_numref(mpq))
-      && mpz_fits_uint_p(mpq_denref(mpq)))
+    if ( fits_lword(mpq_numref(mpq))
+      && fits_lword(mpq_denref(mpq)))
     {
-      num = mpz_get_si(mpq_numref(mpq));
-      den = mpz_get_ui(mpq_denref(mpq));
+      num = get_lword(mpq_numref(mpq));
+      den = get_lword(mpq_denref(mpq));
       has_word = true;
     }
     else
@@ -362,6 +436,7 @@ public:
   void print         ( std::ostream & ) const;
 
   inline double get_d  ( ) const;
+  inline long   get_si ( ) const;   // Integral values that fit a long only
   std::string   get_str( ) const;
 
   inline bool operator==(const FastRational& b) const;
@@ -370,7 +445,7 @@ public:
 
 private:
 
-  inline FastRational(word n, uword d);
+  inline FastRational(lword n, ulword d);
 
   void print_(std::ostream& out) const;
   static inline int compare(lword a, lword b) {
@@ -379,9 +454,25 @@ private:
     else return 0;
   }
 
+  static inline FastInteger wordToInteger(lword x) {
+    if (x >= WORD_MIN && x <= WORD_MAX) {
+      return FastInteger(word(x));
+    }
+    mpz_t tmp;
+    mpz_init(tmp);
+    set_lword(tmp, x);
+    FastInteger ret(tmp);
+    mpz_clear(tmp);
+    return ret;
+  }
+
+  //
+  // The word representation uses 64 bits, with
+  // |num| <= LWORD_MAX and 0 < den <= LWORD_MAX
+  //
   bool has_mpq, has_word;
-  word num;
-  uword den;
+  lword num;
+  ulword den;
   mpq_t mpq;
 
 public:
@@ -400,7 +491,7 @@ public:
   inline FastInteger get_num( ) const
   {
     if (has_word)
-      return FastInteger(num);
+      return wordToInteger(num);
     else
       return FastInteger(mpq_numref(mpq));
   }
@@ -408,7 +499,7 @@ public:
   inline FastInteger get_den( ) const
   {
     if (has_word)
-      return FastInteger(den);
+      return wordToInteger(den);
     else
       return FastInteger(mpq_denref(mpq));
   }
@@ -417,10 +508,10 @@ public:
   {
     if (has_word)
     {
-      word ret = (num > 0 ? (uword)num : (uword)(-num) ) / den;
-      if ( num < 0 ) ret = -ret;
-      else ++ret;
-      return ret;
+      if ( den == 1 ) return *this;
+      lword ret = num / lword(den);
+      if ( num > 0 ) ++ret;
+      return FastRational( ret, 1 );
     }
     else
     {
@@ -435,7 +526,22 @@ public:
 
   inline FastRational floor( ) const
   {
-    return ceil( ) - 1;
+    if (has_word)
+    {
+      if ( den == 1 ) return *this;
+      lword ret = num / lword(den);
+      if ( num < 0 ) --ret;
+      return FastRational( ret, 1 );
+    }
+    else
+    {
+      mpz_class q;
+      mpz_fdiv_q ( q.get_mpz_t( )
+	         , mpq_numref( mpq )
+	         , mpq_denref( mpq ) );
+      FastRational ret( q );
+      return ret;
+    }
   }
 
   bool isWellFormed() const;
@@ -731,7 +837,7 @@ inline bool FastRational::operator==(const FastRational& b) const {
 }
 
 inline FastRational FastRational::operator-() const {
-  if (has_word && num > WORD_MIN) {
+  if (has_word) {
     return FastRational(-num, den);
   } else {
     force_make_mpq();
@@ -748,8 +854,11 @@ inline int FastRational::compare(const FastRational& b) const {
   if (has_word && b.has_word) {
     if (b.den == den) {
       return compare(num, b.num);
-    } else {
-      return compare(lword(num)*b.den, lword(b.num)*den);
+    }
+    lword l, r;
+    if (!lword_mul_overflow(num, b.den, l)
+     && !lword_mul_overflow(b.num, den, r)) {
+      return compare(l, r);
     }
   }
   force_make_mpq();
@@ -948,57 +1057,96 @@ inline bool FastRational::isWellFormed() const
         && ( !has_mpq  || mpz_sgn(mpq_denref(mpq))!=0 );
 }
 
-inline FastRational::FastRational(word n, uword d) : has_mpq(false), has_word(true) {
-  assert(d > 0);
+inline FastRational::FastRational(lword n, ulword d) : has_mpq(false), has_word(true) {
+  assert(d > 0 && d <= ulword(LWORD_MAX));
+  assert(n != LWORD_MIN);
   if (n == 0) {
     num = 0;
     den = 1;
-  } else if (n > 0) {
-    word common = gcd(uword(n), d);
-    num = n/common;
-    den = d/common;
   } else {
-    word common = gcd(uword(-n), d);
-    num = n/common;
+    ulword common = gcd(absVal(n), d);
+    num = n/lword(common);
     den = d/common;
   }
 }
 
+//
+// Word-level kernels of the arithmetic operations on
+// FastRational: they compute the normalized result
+// in 64 bits, or return false if it does not fit
+//
+static inline bool addWords(lword an, ulword ad, lword bn, ulword bd,
+                            lword& rn, ulword& rd) {
+  lword n;
+  if (ad == bd) {
+    if (lword_add_overflow(an, bn, n)) return false;
+    if (n == 0) {
+      rn = 0;
+      rd = 1;
+      return true;
+    }
+    ulword common = gcd(absVal(n), ad);
+    rn = n/lword(common);
+    rd = ad/common;
+    return true;
+  }
+  // Knuth's trick: gcd(n, ad*bd) = gcd(n, gcd(ad, bd))
+  ulword g = gcd(ad, bd);
+  lword n1, n2, d;
+  if (lword_mul_overflow(an, lword(bd/g), n1)
+   || lword_mul_overflow(bn, lword(ad/g), n2)
+   || lword_add_overflow(n1, n2, n)
+   || lword_mul_overflow(lword(ad/g), lword(bd), d)) {
+    return false;
+  }
+  if (n == 0) {
+    rn = 0;
+    rd = 1;
+    return true;
+  }
+  ulword common = g == 1 ? 1 : gcd(absVal(n), g);
+  rn = n/lword(common);
+  rd = ulword(d)/common;
+  return true;
+}
+
+static inline bool mulWords(lword an, ulword ad, lword bn, ulword bd,
+                            lword& rn, ulword& rd) {
+  if (an == 0 || bn == 0) {
+    rn = 0;
+    rd = 1;
+    return true;
+  }
+  ulword common1 = gcd(absVal(an), bd), common2 = gcd(absVal(bn), ad);
+  lword n, d;
+  if (lword_mul_overflow(an/lword(common1), bn/lword(common2), n)
+   || lword_mul_overflow(lword(ad/common2), lword(bd/common1), d)) {
+    return false;
+  }
+  rn = n;
+  rd = d;
+  return true;
+}
+
+static inline bool divWords(lword an, ulword ad, lword bn, ulword bd,
+                            lword& rn, ulword& rd) {
+  assert(bn != 0);
+  return mulWords(an, ad, bn < 0 ? -lword(bd) : lword(bd), absVal(bn), rn, rd);
+}
+
 inline void addition(FastRational& dst, const FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    if (b.num == 0) {
-      dst.num = a.num;
-      dst.den = a.den;
-    } else if (a.num == 0) {
-      dst.num = b.num;
-      dst.den = b.den;
-    } else if (b.den == 1) {
-      CHECK_WORD(dst.num, lword(a.num) + lword(b.num)*a.den);
-      dst.den = a.den;
-    } else if (a.den == 1) {
-      CHECK_WORD(dst.num, lword(b.num) + lword(a.num)*b.den);
-      dst.den = b.den;
-    } else {
-      lword n = lword(a.num)*b.den + lword(b.num)*a.den;
-      ulword d = ulword(a.den) * b.den;
-      lword common = gcd(absVal(n), d);
-      word zn;
-      uword zd;
-      if (common > 1) {
-	CHECK_WORD(zn, n/common);
-	CHECK_UWORD(zd, d/common);
-      } else {
-	CHECK_WORD(zn, n);
-	CHECK_UWORD(zd, d);
-      }
+    lword zn;
+    ulword zd;
+    if (addWords(a.num, a.den, b.num, b.den, zn, zd)) {
       dst.num = zn;
       dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
     }
-    dst.kill_mpq();
-    return;
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1008,39 +1156,17 @@ inline void addition(FastRational& dst, const FastRational& a, const FastRationa
 
 inline void subtraction(FastRational& dst, const FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    if (b.num == 0) {
-      dst.num = a.num;
-      dst.den = a.den;
-    } else if (a.num == 0) {
-      dst.num = -b.num;
-      dst.den = b.den;
-    } else if (b.den == 1) {
-      CHECK_WORD(dst.num, lword(a.num) - lword(b.num)*a.den);
-      dst.den = a.den;
-    } else if (a.den == 1) {
-      CHECK_WORD(dst.num, -lword(b.num) + lword(a.num)*b.den);
-      dst.den = b.den;
-    } else {
-      lword n = lword(a.num)*b.den - lword(b.num)*a.den;
-      ulword d = ulword(a.den) * b.den;
-      lword common = gcd(absVal(n), d);
-      word zn;
-      uword zd;
-      if (common > 1) {
-	CHECK_WORD(zn, n/common);
-	CHECK_UWORD(zd, d/common);
-      } else {
-	CHECK_WORD(zn, n);
-	CHECK_UWORD(zd, d);
-      }
+    lword zn;
+    ulword zd;
+    if (addWords(a.num, a.den, -b.num, b.den, zn, zd)) {
       dst.num = zn;
       dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
     }
-    dst.kill_mpq();
-    return;
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1067,34 +1193,17 @@ inline void multiplication(FastRational& dst, const FastRational& a, const FastR
   }
 
   if (a.has_word && b.has_word) {
-    word zn;
-    uword zd;
-    word common1 = gcd(absVal(a.num), b.den), common2 = gcd(a.den, absVal(b.num));
-    lword k1, k2, k3, k4;
-    if (common1 > 1) {
-      k1 = lword(a.num)/common1;
-      k4 = ulword(b.den)/common1;
-    } else {
-      k1 = lword(a.num);
-      k4 = ulword(b.den);
-    }
-    if (common2 > 1) {
-      k2 = lword(b.num)/common2;
-      k3 = ulword(a.den)/common2;
-    } else {
-      k2 = lword(b.num);
-      k3 = ulword(a.den);
+    lword zn;
+    ulword zd;
+    if (mulWords(a.num, a.den, b.num, b.den, zn, zd)) {
+      dst.num = zn;
+      dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
     }
-    CHECK_WORD(zn, k1 * k2);
-    CHECK_UWORD(zd, k3 * k4);
-    dst.num = zn;
-    dst.den = zd;
-    dst.has_word = true;
-    dst.kill_mpq();
-    return;
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1104,21 +1213,17 @@ inline void multiplication(FastRational& dst, const FastRational& a, const FastR
 
 inline void division(FastRational& dst, const FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    word common1 = gcd(absVal(a.num), absVal(b.num));
-    word common2 = gcd(a.den, b.den);
-    word zn;
-    uword zd;
-    CHECK_WORD(zn, (lword(a.num)/common1) * (b.den/common2));
-    CHECK_UWORD(zd, ulword(absVal(b.num)/common1) * (a.den/common2));
-    dst.num = zn;
-    dst.den = zd;
-    if (b.num < 0) dst.num=-dst.num;
-    dst.has_word = true;
-    dst.kill_mpq();
-    return;
+    lword zn;
+    ulword zd;
+    if (divWords(a.num, a.den, b.num, b.den, zn, zd)) {
+      dst.num = zn;
+      dst.den = zd;
+      dst.has_word = true;
+      dst.kill_mpq();
+      return;
+    }
   }
 
- overflow:
   a.force_make_mpq();
   b.force_make_mpq();
   dst.make_erase_mpq();
@@ -1135,38 +1240,34 @@ inline double FastRational::get_d() const {
   }
 }
 
+inline long FastRational::get_si() const {
+  if (has_word) {
+    assert(den == 1);
+    assert(num >= LONG_MIN && num <= LONG_MAX);
+    return long(num);
+  } else {
+    assert(has_mpq);
+    assert(mpz_cmp_ui(mpq_denref(mpq), 1) == 0);
+    assert(mpz_fits_slong_p(mpq_numref(mpq)));
+    return mpz_get_si(mpq_numref(mpq));
+  }
+}
 
 inline void additionAssign(FastRational& a, const FastRational& b){
   if (b.has_word) {
     if (b.num == 0) return;
     if (a.has_word) {
-      if (b.den == 1) {
-	CHECK_WORD(a.num, lword(a.num) + lword(b.num)*a.den);
-      } else if (a.num == 0) {
-	a.num = b.num;
-	a.den = b.den;
-      } else {
-	lword n = lword(a.num)*b.den + lword(b.num)*a.den;
-	ulword d = ulword(a.den) * b.den;
-	lword common = gcd(absVal(n), d);
-	word zn;
-	uword zd;
-	if (common > 1) {
-	  CHECK_WORD(zn, n/common);
-	  CHECK_UWORD(zd, d/common);
-	} else {
-	  CHECK_WORD(zn, n);
-	  CHECK_UWORD(zd, d);
-	}
-	a.num = zn;
-	a.den = zd;
+      lword zn;
+      ulword zd;
+      if (addWords(a.num, a.den, b.num, b.den, zn, zd)) {
+        a.num = zn;
+        a.den = zd;
+        a.kill_mpq();
+        return;
       }
-      a.kill_mpq();
-      return;
     }
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_add(a.mpq, a.mpq, b.mpq);
@@ -1175,23 +1276,16 @@ inline void additionAssign(FastRational& a, const FastRational& b){
 
 inline void subtractionAssign(FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    uword common = gcd(a.den, b.den);
-    COMPUTE_WORD(n1, lword(a.num) * (b.den / common));
-    COMPUTE_WORD(n2, lword(b.num) * (a.den / common));
-    lword n = lword(n1) - lword(n2);
-    ulword d = ulword(a.den) * (b.den / common);
-    common = gcd(absVal(n), d);
-    word zn;
-    uword zd;
-    CHECK_WORD(zn, n/common);
-    CHECK_UWORD(zd, d/common);
-    a.num = zn;
-    a.den = zd;
-    a.kill_mpq();
-    return;
+    lword zn;
+    ulword zd;
+    if (addWords(a.num, a.den, -b.num, b.den, zn, zd)) {
+      a.num = zn;
+      a.den = zd;
+      a.kill_mpq();
+      return;
+    }
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_sub(a.mpq, a.mpq, b.mpq);
@@ -1200,19 +1294,16 @@ inline void subtractionAssign(FastRational& a, const FastRational& b){
 
 inline void multiplicationAssign(FastRational& a, const FastRational& b){
   if (a.has_word && b.has_word) {
-    word common1 = gcd(absVal(a.num), b.den);
-    word common2 = gcd(a.den, absVal(b.num));
-    word zn;
-    uword zd;
-    CHECK_WORD(zn, lword(a.num/common1) * (b.num/common2));
-    CHECK_UWORD(zd, ulword(a.den/common2) * (b.den/common1));
-    a.num = zn;
-    a.den = zd;
-    a.kill_mpq();
-    return;
+    lword zn;
+    ulword zd;
+    if (mulWords(a.num, a.den, b.num, b.den, zn, zd)) {
+      a.num = zn;
+      a.den = zd;
+      a.kill_mpq();
+      return;
+    }
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_mul(a.mpq, a.mpq, b.mpq);
@@ -1220,29 +1311,17 @@ inline void multiplicationAssign(FastRational& a, const FastRational& b){
 }
 
 inline void divisionAssign(FastRational& a, const FastRational& b){
-
   if (a.has_word && b.has_word) {
-    word common1 = gcd(absVal(a.num), absVal(b.num)),
-         common2 = gcd(a.den, b.den);
-
-    assert( common1 != 0 );
-    assert( common2 != 0 );
-
-    word zn;
-    uword zd;
-    if (b.num < 0) {
-      CHECK_WORD(zn, -lword(a.num/common1) * (b.den/common2));
-    } else {
-      CHECK_WORD(zn,  lword(a.num/common1) * (b.den/common2));
+    lword zn;
+    ulword zd;
+    if (divWords(a.num, a.den, b.num, b.den, zn, zd)) {
+      a.num = zn;
+      a.den = zd;
+      a.kill_mpq();
+      return;
     }
-    CHECK_UWORD(zd, ulword(absVal(b.num)/common1) * (a.den/common2));
-    a.den = zd;
-    a.num = zn;
-    a.kill_mpq();
-    return;
   }
 
- overflow:
   a.make_mpq();
   b.force_make_mpq();
   mpq_div(a.mpq, a.mpq, b.mpq);
@@ -1255,7 +1334,7 @@ inline unsigned FastInteger::size() const {
 }
 
 inline unsigned FastRational::size() const {
-  if (has_word) return 64;
+  if (has_word) return 128;
   return mpz_sizeinbase(mpq_numref(mpq), 2) +
     mpz_sizeinbase(mpq_denref(mpq), 2);
 }
@@ -1265,20 +1344,15 @@ inline FastRational FastRational::inverse() const {
 
   if (has_word) {
     assert(num != 0);
-    word zn;
-    uword zd;
     if (num > 0) {
-      CHECK_WORD(zn, den);
-      CHECK_UWORD(zd, num);
+      dest.num = den;
+      dest.den = num;
     } else {
-      CHECK_WORD(zn, -lword(den));
-      CHECK_UWORD(zd, -lword(num));
+      dest.num = -lword(den);
+      dest.den = -num;
     }
-    dest.num = zn;
-    dest.den = zd;
     return dest;
   }
- overflow:
   dest.has_word = false;
   force_make_mpq();
   dest.make_erase_mpq();
@@ -409,10 +409,13 @@ public:
 					      , const bool );                 // Assert a theory literal
   void                pushBacktrackPoint      ( );                            // Push a backtrack point
   void                popBacktrackPoint       ( );                            // Backtrack to last saved point
+  void                pushScope               ( );                            // Push an incremental scope
+  void                popScope                ( );                            // Forget the atoms informed in the last scope
   Enode *             getDeduction            ( );                            // Return an implied node based on the current state
   Enode *             getSuggestion           ( );                            // Return a suggested literal based on the current state
   vector< Enode * > & getConflict             ( bool = false );               // Get explanation
   bool                check                   ( bool );		              // Check satisfiability
+  lbool               evaluate                ( Enode * );                    // Value of an atom in the models of the ordinary solvers
   void                initializeCong          ( Enode * );                    // Initialize congruence structures for a node
 #ifndef SMTCOMP
   void                computeModel            ( );
@@ -422,7 +425,8 @@ public:
   inline bool         getUseGmp               ( ) { return use_gmp; }
   void                splitOnDemand           ( vector< Enode * > &, int ); // Splitting on demand modulo equality
   void                splitOnDemand           ( Enode *, int );             // Splitting on demand
-  bool                checkDupClause          ( Enode *, Enode * );         // Check if a clause is duplicate    
+  double              getAtomActivity         ( Enode * );                  // SAT activity of an atom, 0 if it has no variable
+  bool                checkDupClause          ( vector< Enode * > & );      // Check if a clause is duplicate    
   void                explain                 ( Enode *
                                               , Enode *
 					      , vector< Enode * > & );      // Exported explain
@@ -597,6 +601,8 @@ private:
   lbool                       status;                           // Keeps status
   set< enodeid_t >            initialized;                      // Keep track of initialized nodes
   map< enodeid_t, lbool >     informed;                         // Keep track of informed nodes
+  vector< Enode * >           informed_trail;                   // Informed nodes, in order (incremental only)
+  vector< size_t >            informed_lim;                     // Size of informed_trail at each scope
   vector< Enode * >           pending;                          // Pending merges
   vector< Enode * >           undo_stack_term;                  // Keeps track of terms involved in operations
   vector< oper_t >            undo_stack_oper;                  // Keeps track of operations
@@ -631,11 +637,7 @@ private:
 
   //============================================================================
 
-#ifdef BUILD_64
-  hash_set< enodeid_pair_t >     clauses_sent;
-#else
-  hash_set< Pair( enodeid_t ) >  clauses_sent;
-#endif
+  set< vector< enodeid_t > >     clauses_sent;                    // Sorted ids of the clauses sent on demand
   
   //===========================================================================
   // MCMT related routines - Implemented in EgraphMCMT.C
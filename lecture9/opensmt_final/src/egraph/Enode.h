@@ -264,6 +264,7 @@ public:
   inline int       getWeightInc        ( )       { assert( isAtom( ) && atom_data ); return atom_data->weight_inc; }
   inline int       getDedIndex         ( ) const { assert( isTerm( ) && atom_data ); return atom_data->ded_index; }
   inline int       getDistIndex        ( ) const { assert( isTerm( ) && atom_data ); return atom_data->dist_index; }
+  inline int       getTSolverSlot      ( const int i ) const { assert( isTerm( ) && atom_data ); return atom_data->slot_owner == i ? atom_data->slot : -1; }
                                        
   inline Enode *   getCb               ( ) const { assert( isTerm( ) && cong_data && cong_data->term_data ); return cong_data->term_data->cb; }
   inline Enode *   getRef              ( ) const { assert( isTerm( ) && cong_data && cong_data->term_data ); return cong_data->root; }
@@ -308,6 +309,7 @@ public:
   inline void      setDecPolarity      ( const lbool s )        { assert( isAtom( ) && atom_data ); atom_data->dec_polarity = s; }
   inline void      setWeightInc        ( const int w )          { assert( isAtom( ) && atom_data ); atom_data->weight_inc = w; }
   inline void      setDistIndex        ( const int d )	        { assert( isTerm( ) && atom_data ); atom_data->dist_index = d; }
+  inline void      setTSolverSlot      ( const int i, const int s ) { assert( isTerm( ) && atom_data ); assert( atom_data->slot_owner == -1 || atom_data->slot_owner == i ); atom_data->slot_owner = i; atom_data->slot = s; }
                    
   inline void      setCb               ( Enode * e )            { assert( isTerm( ) && cong_data && cong_data->term_data ); cong_data->term_data->cb = e; }
 
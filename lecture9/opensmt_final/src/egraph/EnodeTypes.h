@@ -238,6 +238,8 @@ struct AtomData
     , is_deduced   ( false )
     , dec_polarity ( l_Undef )
     , weight_inc   ( 0 )
+    , slot_owner   ( -1 )
+    , slot         ( -1 )
   { }
 
   lbool   polarity;         // Associated polarity on the trail
@@ -248,6 +250,8 @@ struct AtomData
   bool    is_deduced;       // True if deduced
   lbool   dec_polarity;     // Polarity to be used in decisions
   int     weight_inc;       // Initial weight increase
+  int     slot_owner;       // Index of the theory solver that owns slot
+  int     slot;             // Solver specific index of this atom (e.g., its edges in DL)
 };
 //
 // Data for symbols and numbers
@@ -0,0 +1,95 @@
+/*********************************************************************
+OpenSMT -- Copyright (C) 2008-2010, Roberto Bruttomesso
+
+OpenSMT is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenSMT is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenSMT. If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+
+#ifndef DLPREPROC_H
+#define DLPREPROC_H
+
+#include "Global.h"
+#include "Otl.h"
+#include "Egraph.h"
+
+//
+// Static simplification of difference logic formulae. The atoms
+// asserted at top level form a constraint graph: the other atoms
+// that its shortest paths decide are replaced by true or false,
+// and the units implied by the others are dropped. The remaining
+// atoms on the same pair of terms are chained by binary clauses
+//
+class DLPreproc
+{
+public:
+
+  DLPreproc( Egraph & egraph_, Config & config_ )
+    : egraph ( egraph_ )
+    , config ( config_ )
+  { }
+
+  ~DLPreproc( ) { }
+
+  Enode * doit ( Enode * ); // Main routine
+
+private:
+
+  // x - y <= c, vertex 0 stands for the constant 0
+  struct DLAtom
+  {
+    Enode * atom;
+    int     x;
+    int     y;
+    Real    c;
+  };
+
+  struct DLUnitEdge
+  {
+    int  from;
+    int  to;
+    Real wt;
+  };
+
+  // A bound on an ordered pair: lit <=> ( x - y <= c ), where lit
+  // is the atom or its negation
+  struct DLBound
+  {
+    Real    c;
+    Enode * atom;
+    bool    negated;
+    bool operator<( const DLBound & o ) const { return c < o.c; }
+  };
+
+  bool parseAtom       ( Enode *, DLAtom & );                                 // False if it is not a difference constraint
+  int  getVertex       ( Enode * );
+  void collectAtoms    ( Enode * );
+  void collectUnits    ( Enode * );
+  bool computePotential( );                                                   // False if the units are inconsistent
+  void shortestPaths   ( int, vector< Real > &, vector< char > & );           // Dijkstra on the reduced weights
+  void decideAtoms     ( );
+  void addImplications ( list< Enode * > & );
+
+  Egraph &                   egraph;
+  Config &                   config;
+  map< Enode *, int >        vertex_of;      // Term -> vertex
+  vector< DLAtom >           atoms;          // Difference atoms of the formula
+  map< Enode *, size_t >     atom_index;     // Atom -> position in atoms
+  set< Enode * >             pos_units;      // Atoms asserted at top level
+  set< Enode * >             neg_units;      // Atoms negated at top level
+  vector< DLUnitEdge >       unit_edges;     // Edges of the units
+  vector< vector< size_t > > unit_adj;       // Vertex -> outgoing unit edges
+  vector< Real >             pi;             // Feasible potential of the units
+  map< Enode *, bool >       decided;        // Atoms implied by the units, with their value
+};
+
+#endif
@@ -118,6 +118,7 @@ class CoreSMTSolver : public SMTSolver
 #endif
 
     void addNewAtom         ( Enode * );
+    double getAtomActivity  ( Enode * );             // Activity of the variable of an atom, 0 if it has none
 
     vec< Clause * >          axioms;         // List of axioms produced with splitting on demand
     int                      axioms_checked; // Id of next axiom to be checked
@@ -70,6 +70,10 @@ public:
   Lit     enodeToLit           ( Enode * );             // Converts enode into boolean literal. Create a new variable if needed
   Lit     enodeToLit           ( Enode *, Var & );      // Converts enode into boolean literal. Create a new variable if needed
   Enode * varToEnode           ( Var );                 // Return the enode corresponding to a variable
+  inline Var getVar            ( Enode * e )            // Like enodeToVar, but returns var_Undef instead of creating a variable
+  {
+    return (unsigned)e->getId( ) < enode_id_to_var.size( ) ? enode_id_to_var[ e->getId( ) ] : var_Undef;
+  }
   void    clearVar             ( Var );                 // Clear a Var in translation table (used in incremental solving)
                                
   bool    assertLits           ( );                     // Give to the TSolvers the newly added literals on the trail
@@ -49,7 +49,19 @@ struct TSolverStats
     , avg_sod_size      ( 0 )
     , max_sod_size      ( 0 )
     , min_sod_size      ( 32767 )
-  { }
+  {
+    for ( int i = 0 ; i < CONF_HIST_SIZE ; i ++ )
+      conf_size_hist[ i ] = 0;
+  }
+
+  // Conflicts of size 1, 2, 3-4, 5-8, ..., more than 2^(CONF_HIST_SIZE-2)
+  static inline int confHistBucket( size_t size )
+  {
+    int b = 0;
+    while ( b < CONF_HIST_SIZE - 1 && ( (size_t)1 << b ) < size )
+      b ++;
+    return b;
+  }
 
   // Statistics for theory solvers
   void printStatistics ( ostream & os )
@@ -64,6 +76,17 @@ struct TSolverStats
 	os << "# Average conflict size....: " << avg_conf_size / (float)conflicts_sent << endl;
 	os << "# Max conflict size........: " << max_conf_size << endl;
 	os << "# Min conflict size........: " << min_conf_size << endl;
+	for ( int b = 0 ; b < CONF_HIST_SIZE ; b ++ )
+	{
+	  if ( conf_size_hist[ b ] == 0 )
+	    continue;
+	  std::ostringstream label;
+	  if ( b == CONF_HIST_SIZE - 1 )
+	    label << "> " << ( 1 << ( b - 1 ) );
+	  else
+	    label << "<= " << ( 1 << b );
+	  os << "# Conflicts of size " << label.str( ) << string( 7 - label.str( ).size( ), '.' ) << ": " << conf_size_hist[ b ] << endl;
+	}
       }
     }
     if ( sat_calls > 0 )
@@ -96,6 +119,8 @@ struct TSolverStats
   float avg_conf_size;
   int   max_conf_size;
   int   min_conf_size;
+  enum { CONF_HIST_SIZE = 10 };
+  int   conf_size_hist[ CONF_HIST_SIZE ];
   // Deductions statistics
   int   deductions_done;
   int   deductions_sent;
@@ -129,6 +154,9 @@ public:
   virtual void                pushBacktrackPoint  ( )                       = 0;  // Push a backtrack point
   virtual void                popBacktrackPoint   ( )                       = 0;  // Backtrack to last saved point
   virtual bool                check               ( bool )                  = 0;  // Check satisfiability
+  virtual void                pushScope           ( ) { }                         // Push an incremental scope (atoms informed from now on belong to it)
+  virtual void                popScope            ( ) { }                         // Forget the atoms informed in the last scope
+  virtual bool                hasScopes           ( ) { return false; }           // True if popScope really forgets informed atoms
   inline const string &       getName             ( ) { return name; }            // The name of the solver
   virtual lbool               evaluate            ( Enode * ) { return l_Undef; } // Evaluate the expression in the current state
 #ifdef PRODUCE_PROOF
@@ -57,12 +57,16 @@ private:
   bool isIndexEq             ( Enode * );
   bool isElemEq              ( Enode * );
   bool hasReadTerms          ( Enode * );
+  bool isReadEq              ( Enode * );
+  lbool instantiateLemmas    ( );
+  bool instantiateLemma      ( const pair< Enode *, Enode * > &, vector< Enode * > &, Enode *, Enode *, Enode *, Enode *, vector< vector< Enode * > > & );
 
   //
   // Defines the set of operations that can be performed and that should be undone
   //
   typedef enum { 
     ASSERT_LIT
+  , NEW_LEMMA
   } oper_t;
 
   RewriteEngine * re_p;
@@ -79,6 +83,14 @@ private:
   unsigned      nof_asserted_index_eqs;
   unsigned      nof_read_terms;
   unsigned      nof_asserted_read_terms;
+
+  vector< Enode * >                  read_eqs;     // Asserted rd( a, i ) = d, for lazy lemmas
+  set< pair< Enode *, Enode * > >    lemmas_done;  // Lemmas already sent, by read equality and other read or store
+  vector< pair< Enode *, Enode * > > lemmas_trail; // Lemmas_done in insertion order, for backtracking
+#ifdef STATISTICS
+  int           lemmas_sent;                       // Number of read-over-write lemmas instantiated
+  int           lemmas_useful;                     // Number of lemmas that were conflicting
+#endif
 };
 
 #endif
@@ -0,0 +1,110 @@
+/*********************************************************************
+OpenSMT -- Copyright (C) 2010, Roberto Bruttomesso
+
+OpenSMT is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenSMT is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenSMT. If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+
+#ifndef AXWEAKSOLVER_H
+#define AXWEAKSOLVER_H
+
+#include "TSolver.h"
+
+//
+// Array solver based on weak equivalence. Arrays are the
+// congruence classes of the Egraph, linked by an edge for
+// each store term. Two arrays are weakly equivalent on i if
+// a path joins them with no store on an index equal to i:
+// their reads on i must then agree. Violations are sent as
+// lemmas, explained with the path and the Egraph
+//
+class AXWeakSolver : public OrdinaryTSolver
+{
+public:
+
+  AXWeakSolver( const int
+              , const char *
+	      , Config &
+	      , Egraph &
+	      , SStore &
+	      , vector< Enode * > &
+	      , vector< Enode * > &
+              , vector< Enode * > & );
+
+  ~AXWeakSolver ( );
+
+  lbool   inform             ( Enode * );
+  bool    assertLit          ( Enode *, bool = false );
+  void    pushBacktrackPoint ( );
+  void    popBacktrackPoint  ( );
+  bool    check              ( bool );
+  bool    belongsToT         ( Enode * );
+  void    computeModel       ( );
+#ifdef PRODUCE_PROOF
+  Enode * getInterpolants    ( );
+#endif
+
+private:
+
+  //
+  // A read of array arr on idx with value val. A store
+  // wr( a, i, e ) also reads e on i from itself
+  //
+  struct ReadTerm
+  {
+    ReadTerm( Enode * a, Enode * i, Enode * v ) : arr( a ), idx( i ), val( v ) { }
+
+    Enode * arr;
+    Enode * idx;
+    Enode * val;
+  };
+
+  typedef map< Enode *, vector< Enode * > > graph_t;           // Class root to incident stores
+  typedef vector< vector< Enode * > >       lemmas_t;          // Lemmas to be sent
+
+  //
+  // Defines the set of operations that can be performed and that should be undone
+  //
+  typedef enum {
+    NEW_LEMMA
+  , NEW_EXT
+  } oper_t;
+
+  void    registerTerms      ( Enode * );
+  bool    readOverWeakEq     ( lemmas_t & );                   // Collects lemmas for reads that disagree
+  bool    extensionality     ( lemmas_t & );                   // Collects lemmas for diff terms
+  bool    matchReads         ( vector< ReadTerm > &, vector< size_t > &, map< Enode *, Enode * > &, Enode *, graph_t &, lemmas_t & );
+  bool    instantiate        ( ReadTerm &, ReadTerm &, Enode *, graph_t &, lemmas_t & );
+  bool    findPath           ( Enode *, Enode *, Enode *, graph_t &, vector< Enode * > & );
+  void    explainEq          ( Enode *, Enode *, map< enodeid_t, Enode * > & );
+  Enode * find               ( map< Enode *, Enode * > &, Enode * );
+
+  inline Enode * root        ( Enode * e ) { return e->getRoot( ); }
+
+  vector< Enode * >           selects;                         // Read terms seen
+  vector< Enode * >           stores;                          // Store terms seen
+  vector< Enode * >           diffs;                           // Diff terms seen
+  vector< Enode * >           array_eqs;                       // Equalities between arrays
+  set< Enode * >              registered;                      // Terms already seen
+  set< Enode * >              ext_done;                        // Diff terms already extended
+  set< vector< enodeid_t > >  lemmas_done;                     // Lemmas already sent, by literal ids
+  vector< oper_t >            undo_stack_oper;                 // Insertions into ext_done and lemmas_done
+  vector< Enode * >           ext_trail;                       // Ext_done in insertion order
+  vector< vector< enodeid_t > > lemmas_trail;                  // Lemmas_done in insertion order
+#ifdef STATISTICS
+  int                         row_lemmas_sent;                 // Number of read over weak equivalence lemmas
+  int                         ext_lemmas_sent;                 // Number of extensionality lemmas
+#endif
+};
+
+#endif
@@ -203,7 +203,47 @@ private:
 #endif
   };
 
-  typedef map< Enode *, RewriteRule * > ground_rules_t;
+  //
+  // Ground rules by key (the lhs, with the index of selects
+  // replaced by its root). Rules that C3 and R2 apply to are
+  // also indexed, by array for reads and by rhs for stores,
+  // so that they are not searched by scanning the whole set
+  //
+  struct GroundRules : public map< Enode *, RewriteRule * >
+  {
+    inline void add( Enode * key, RewriteRule * rule )
+    {
+      assert( find( key ) == end( ) );
+      (*this)[ key ] = rule;
+      if ( rule->lhs->isSelect( ) )
+	reads_of[ rule->lhs->get1st( ) ].insert( rule );
+      else if ( rule->rhs->isStore( ) )
+	to_stores.insert( rule );
+    }
+
+    inline void remove( Enode * key )
+    {
+      iterator it = find( key );
+      assert( it != end( ) );
+      RewriteRule * rule = it->second;
+      erase( it );
+      if ( rule->lhs->isSelect( ) )
+      {
+	map< Enode *, set< RewriteRule * > >::iterator jt = reads_of.find( rule->lhs->get1st( ) );
+	assert( jt != reads_of.end( ) );
+	jt->second.erase( rule );
+	if ( jt->second.empty( ) )
+	  reads_of.erase( jt );
+      }
+      else if ( rule->rhs->isStore( ) )
+	to_stores.erase( rule );
+    }
+
+    map< Enode *, set< RewriteRule * > > reads_of;  // rd( a, i ) --> d, by a
+    set< RewriteRule * >                  to_stores; // a --> wr( b, i, e )
+  };
+
+  typedef GroundRules ground_rules_t;
 
   void    addIndexRule          ( Enode *, Enode *, Enode *, vector< RewriteRule * > & );
 
@@ -55,34 +55,50 @@ class CostSolver : public OrdinaryTSolver
   struct costfun;
 
   /*
-   * Holds a (incur v c t) predicate in a linked list
-   * The list maintained sorted on c.
+   * Holds a (incur v c t) predicate in an incurlist
    */
   struct incurnode {
     costfun & fun;
     Enode * atom;
-    incurnode * prev;
-    incurnode * next;
+    size_t pos;
+    bool unassigned;
     codomain cost;
     incurnode( costfun & f, Enode * a, const codomain & c )
-      : fun( f ), atom( a ), prev( 0 ), next( 0 ), cost( c ) { }
+      : fun( f ), atom( a ), pos( 0 ), unassigned( true ), cost( c ) { }
   };
 
   /*
-   * The header for the linked list
+   * All the incur predicates of a cost variable, in an array
+   * sorted on c. Two Fenwick trees over the array sum the costs
+   * and count the predicates that are still unassigned, so that
+   * the slack, its prefix sums and the most costly unassigned
+   * predicate are found in O(log n). New predicates are sorted
+   * in at the first query.
    */
   struct incurlist {
-    incurnode * head;
-    incurnode * last;
-    incurlist() : head( 0 ), last( 0 ) {}
+    std::vector< incurnode * > nodes;
+    std::vector< codomain > costs;
+    std::vector< int > counts;
+    bool sorted;
+    incurlist() : sorted( true ) {}
+    void insert( incurnode * node );
+    void remove( incurnode * node );
+    void restore( incurnode * node );
+    incurnode * last();
+    codomain sum( size_t n );
+    codomain slack() { return sum( nodes.size() ); }
+  private:
+    void update( size_t pos, const codomain & cost, int count );
+    void rebuild();
+    static bool lessCost( incurnode * x, incurnode * y ) { return x->cost < y->cost; }
   };
 
   /*
    * Holds all information for a cost variable:
-   *   - All unassigned incur predicates in a sorted linked list
+   *   - All incur predicates in a sorted incurlist, which also
+   *     gives the sum of the unassigned incurrable costs (slack)
    *   - All assigned incur predicates
    *   - The currently incurred cost
-   *   - The sum of the unassigned incurrable costs (slack)
    *   - The current upper and lower bounds
    */
   typedef Enode * bound;
@@ -92,11 +108,11 @@ class CostSolver : public OrdinaryTSolver
     nodes_t assigned;
     incurlist unassigned;
     codomain incurred;
-    codomain slack;
     typedef std::stack< bound > bounds_t;
     bounds_t upperbound;
     bounds_t lowerbound;
-    costfun( Enode * var ) : variable( var ), incurred( 0 ), slack( 0 ) { }
+    costfun( Enode * var ) : variable( var ), incurred( 0 ) { }
+    codomain slack() { return unassigned.slack(); }
   };
 
   // Hash function for Enode pointers
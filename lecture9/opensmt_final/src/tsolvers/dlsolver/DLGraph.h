@@ -25,6 +25,9 @@ along with OpenSMT. If not, see <http://www.gnu.org/licenses/>.
 #include "Enode.h"
 #include "Egraph.h"
 #include "Config.h"
+#include "DLHeap.h"
+
+#include <deque>
 
 #define HASH_SET 0
 #define LAZY_GENERATION 1
@@ -233,7 +236,7 @@ template< class T > class DLGraph
 {
 public:
 
-    DLGraph( Config & config_, Egraph & egraph_ ) 
+    DLGraph( Config & config_, Egraph & egraph_, const int solver_id_ ) 
       : Vcnt		   ( 0 ) 
       , Ecnt		   ( 0 )
       , active_pi_prime	   ( false )
@@ -254,8 +257,9 @@ public:
       , dfs_visited_count  ( 0 )
       , active_dfs_finished( false )
       , dfs_finished_count ( 0 )
-      , active_apsp_inf    ( false )
-      , apsp_inf_count     ( 0 )
+      , zero_vertex        ( -1 )
+      , dx_heap            ( true )
+      , dy_heap            ( false )
       , max_dist_from_src  ( 0 )
       , max_dist_from_dst  ( 0 )
       , max_adj_list_size  ( 0 )
@@ -264,7 +268,12 @@ public:
       , after_backtrack    ( false )
       , config             ( config_ )
       , egraph             ( egraph_ )
-  { } 
+      , solver_id          ( solver_id_ )
+  {
+#ifdef STATISTICS
+    truncated_searches = 0;
+#endif
+  }
 
    ~DLGraph( );
 
@@ -273,14 +282,24 @@ public:
   typedef __gnu_cxx::SizeTDLEdge< const DLEdge<T> * > HashDLEdge;
   typedef vector< DLEdge<T> * >                       DLPath;
 
-  typedef map< Enode *, DLVertex<T> * >	  Enode2Vertex;
-  typedef map< Enode *, DLComplEdges<T> > Enode2Edge;
-
   inline unsigned getVcnt ( ) const { return Vcnt; }
   inline unsigned getEcnt ( ) const { return Ecnt; }
 
-  inline Enode2Edge &            getEdgeMap        ( ) { return edgeMap; }
   inline vector< AdjList > &     getDAdj           ( ) { return dAdj; }
+
+  //
+  // Value of an atom under the current potential. pi satisfies
+  // the active edges u -> v, i.e. pi( v ) - pi( u ) <= wt
+  //
+  inline lbool evaluate( Enode * c )
+  {
+    DLEdge<T> * e = getEdges( c ).pos;
+    const T diff = e->v->pi - e->u->pi;
+    if ( c->isEq( ) )
+      return diff == e->wt ? l_True : l_False;
+    return diff <= e->wt ? l_True : l_False;
+  }
+  void                           getSuggestions    ( Enode *, vector< Enode * > & );
   inline vector< DLEdge<T> * > & getConflictEdges  ( ) { return conflict_edges; }
   inline DLVertex<T> *           getNegCycleVertex ( ) { return negCycleVertex; }
   inline double                  getDynGraphDensity( ) { return (double) dEdges.size( ) / (double) Vcnt; }
@@ -301,8 +320,11 @@ public:
   void	      deleteActive  ( Enode *, const bool );
   void	      deleteInactive( Enode * );
 
-  inline DLEdge<T> * getOppositePolarityEdge( Enode * c ) { assert( c->hasPolarity( ) );  assert( edgeMap.find( c ) != edgeMap.end( ) );    DLComplEdges<T> edges = edgeMap.find( c )->second;     DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.neg : edges.pos;  assert( e ); return e;  }
-  inline DLEdge<T> * getEdgeWithPolarity    ( Enode * c ) { assert( c->hasPolarity( ) );  assert( edgeMap.find( c ) != edgeMap.end( ) );    DLComplEdges<T> edges = edgeMap.find( c )->second;     DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.pos : edges.neg;  assert( e ); return e;  }
+  // Edges of an atom, through the slot set by getDLEdge
+  inline DLComplEdges<T> & getEdges( Enode * c ) { const int slot = c->getTSolverSlot( solver_id ); assert( slot >= 0 && slot < (int)atom_edges.size( ) ); return atom_edges[ slot ]; }
+
+  inline DLEdge<T> * getOppositePolarityEdge( Enode * c ) { assert( c->hasPolarity( ) ); DLComplEdges<T> & edges = getEdges( c ); DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.neg : edges.pos;  assert( e ); return e;  }
+  inline DLEdge<T> * getEdgeWithPolarity    ( Enode * c ) { assert( c->hasPolarity( ) ); DLComplEdges<T> & edges = getEdges( c ); DLEdge<T> * e = c->getPolarity( ) == l_True ? edges.pos : edges.neg;  assert( e ); return e;  }
 
   inline void updateDynDegree( DLEdge<T> * e )
   {
@@ -351,6 +373,8 @@ public:
         e->r = edge;
 	if ( findShortestPath( e ) )               // added for eager_lazy schema
 	{	
+	  if ( config.dl_short_explanations > 0 )
+	    shortenImplyingPath( e );
 	  heavy_edges.push_back( e );
 	  undo_stack_deduced_edges.push_back( e ); // added for eager_lazy schema
 	}
@@ -360,8 +384,22 @@ public:
     }
   }
 
-  void	          findHeavyEdgesFW  ( Enode *  );  // find heavy edges with the Floyd-Warshall's algorithm
-  void	          iterateInactiveFW ( );	   // iterate through the set of inactive edges
+  //
+  // With dl_propagation_limit only the heavy edges of the most
+  // active atoms are deduced, so they are collected first
+  //
+  inline void addCandidate( const T & rpath_wt, DLEdge<T> * e )
+  {
+    assert ( ! e->c->hasPolarity( ) && ! e->c->isDeduced( ) );
+    if ( rpath_wt + e->v->pi - e->u->pi <= e->wt )
+    {
+      DLCandidate cand;
+      cand.activity = egraph.getAtomActivity( e->c );
+      cand.rpath_wt = rpath_wt;
+      cand.e = e;
+      candidates.push_back( cand );
+    }
+  }
 
   inline DLPath & getShortestPath   ( DLEdge<T> *e ) { assert( e ); return shortest_paths[ e->id ]; }
   inline void     clearShortestPath ( DLEdge<T> *e ) { assert( e ); shortest_paths[ e->id ].clear( ); clearSPTs( ); }
@@ -378,6 +416,9 @@ public:
   
   vector< DLVertex<T> * > vertices;
   vector< DLEdge<T> * >   heavy_edges;              // TODO: deal with it when backtracking!
+#ifdef STATISTICS
+  unsigned                truncated_searches;       // Propagation searches stopped by dl_propagation_budget
+#endif
 
   vector< Enode *  >    undo_stack_inactive_enodes; //  stack of inactive edges
   vector< DLEdge<T> * > undo_stack_deduced_edges;   //  stack of deduced edges
@@ -396,6 +437,9 @@ public:
 private:
 
   bool        checkNegCycle_     ( DLEdge<T> * );
+  void        shortenNegCycle    ( DLEdge<T> * );
+  void        shortenImplyingPath( DLEdge<T> * );
+  bool        findFewestEdgesPath( DLVertex<T> *, DLVertex<T> *, const T &, const bool, const unsigned, DLPath & );
   void        storeNegCycle      ( vector< Enode * > &, set< Enode * > & );
 #ifdef PRODUCE_PROOF
   Enode *     mergeInterpolants  ( Enode *, Enode *, Enode * );
@@ -407,24 +451,38 @@ private:
 
   inline DLVertex<T> * getDLVertex( Enode * x )   
   {	
-    if ( vertexMap.find( x ) == vertexMap.end( ) )
+    if ( x != NULL && x->getId( ) >= (int)enode_vertex.size( ) )
+      enode_vertex.resize( x->getId( ) + 1, -1 );
+    int & slot = x == NULL ? zero_vertex : enode_vertex[ x->getId( ) ];
+    if ( slot < 0 )
     {
-      DLVertex<T> * v = new DLVertex<T>( x, vertexMap.size( ) );
-      vertexMap.insert( pair< Enode *, DLVertex<T> *> (x, v) );	
-      vertices.resize( vertexMap.size( ) ); vertices[v->id] = v;
-      return v;
+      slot = vertices.size( );
+      vertex_pool.push_back( DLVertex<T>( x, slot ) );
+      vertices.push_back( &vertex_pool.back( ) );
     }
-
-    return vertexMap.find( x )->second;
+    return vertices[ slot ];
   }
 
-  DLComplEdges<T> getDLEdge( Enode * );
+  DLComplEdges<T> & getDLEdge( Enode * );
 
-  inline Real & getPosWeight ( Real & weight ) { (void)weight; return tmp_edge_weight; }
-  inline long & getPosWeight ( long & weight ) 
-  { 
-    weight = atol( tmp_edge_weight.get_str( ).c_str( ) ); 
-    return weight; 
+  inline DLEdge<T> * newDLEdge( Enode * c, int id, DLVertex<T> * u, DLVertex<T> * v, T & wt )
+  {
+    edge_pool.push_back( DLEdge<T>( c, id, u, v, wt ) );
+    return &edge_pool.back( );
+  }
+
+  // Weights are converted once, when the edges are built
+  inline void toWeight ( const Real & r, Real & weight ) { weight = r; }
+  inline void toWeight ( const Real & r, long & weight )
+  {
+#if FAST_RATIONALS
+    weight = r.get_si( );
+#elif USE_GMP
+    assert( r.get_den( ) == 1 );
+    weight = r.get_num( ).get_si( );
+#else
+    weight = static_cast< long >( r );
+#endif
   }
 
   // Fast pi prime update check. Cannot be nested!
@@ -481,13 +539,6 @@ private:
   inline bool isDfsFinished   ( DLVertex<T> * v ) { assert (  active_dfs_finished ); assert( v->id < (int) dfs_finished.size( ) ); return dfs_finished[ v->id ] == dfs_finished_count; }
   inline void doneDfsFinished ( )	          { assert (  active_dfs_finished ); active_dfs_finished = false; }
 
-  // Fast infinity distance check in apsp distance matrix. Cannot be nested.
-  inline void initInfAPSP   ( )		      { assert ( !active_apsp_inf ); active_apsp_inf = true; apsp_infs.resize( Vcnt ); for( unsigned i = 0; i < Vcnt; ++i ) apsp_infs[i].resize(Vcnt, apsp_inf_count ); ++ apsp_inf_count; }
-  inline void updateAPSP    ( int i, int j )  { assert (  active_apsp_inf ); assert( i < (int) apsp_infs.size( ) ); assert( j < (int) apsp_infs[ i ].size( ) ); apsp_infs[ i ][ j ] = apsp_inf_count; }
-  inline void invalidateAPSP( int i, int j )  { assert (  active_apsp_inf ); assert( i < (int) apsp_infs.size( ) ); assert( j < (int) apsp_infs[ i ].size( ) ); apsp_infs[ i ][ j ] = 0; }
-  inline bool isValidAPSP   ( int i, int j )  { assert (  active_apsp_inf ); assert( i < (int)apsp_infs.size( ) ); assert( j < (int)apsp_infs[ i ].size( ) ); return apsp_infs[ i ][ j ] == apsp_inf_count; }
-  inline void doneInfAPSP   ( )		      { assert (  active_apsp_inf ); active_apsp_inf = false; }
-
   // Dotty pretty print
   void printDynGraphAsDotty( const char *, DLEdge<T> *e = NULL );
   inline void printEdgeWPi ( ofstream & out, DLEdge<T> * e)
@@ -542,10 +593,39 @@ private:
   void printDeducedAsDotty(  const char * );
 
   void printAdjMatrix( const char * );
-  void printAPSPMatrix( const char * );
+
+  // Heap of vertices on gamma, with decrease key
+  inline void pushGammaHeap( DLVertex<T> * v )
+  {
+    assert( gamma_heap_pos[ v->id ] < 0 );
+    vertex_heap.push_back( v );
+    siftUpGammaHeap( vertex_heap.size( ) - 1 );
+  }
+  inline void decreaseGammaHeap( DLVertex<T> * v ) { assert( gamma_heap_pos[ v->id ] >= 0 ); siftUpGammaHeap( gamma_heap_pos[ v->id ] ); }
+  inline DLVertex<T> * popGammaHeap( )
+  {
+    DLVertex<T> * top = vertex_heap.front( );
+    gamma_heap_pos[ top->id ] = -1;
+    DLVertex<T> * last = vertex_heap.back( );
+    vertex_heap.pop_back( );
+    if ( !vertex_heap.empty( ) )
+    {
+      vertex_heap[ 0 ] = last;
+      siftDownGammaHeap( 0 );
+    }
+    return top;
+  }
+  inline void clearGammaHeap( )
+  {
+    for ( size_t i = 0 ; i < vertex_heap.size( ) ; i ++ )
+      gamma_heap_pos[ vertex_heap[ i ]->id ] = -1;
+    vertex_heap.clear( );
+  }
+  void siftUpGammaHeap  ( int );
+  void siftDownGammaHeap( int );
 
   //  SSSP computation
-  void findSSSP( DLVertex<T> *, DL_sssp_direction );
+  bool findSSSP( DLVertex<T> *, DL_sssp_direction ); // False if the search was stopped by dl_propagation_budget
   inline void insertRelevantVertices( DLVertex<T> * v, DL_sssp_direction go )
   { 
     if( go == DL_sssp_forward )
@@ -562,51 +642,7 @@ private:
     }
   }
 
-  inline void pushPBheap( DL_sssp_direction go, DLVertex<T> * v )
-  { 
-    if ( go == DL_sssp_forward )
-    {
-      assert( v->id < (int)pq_dx_it.size( ) );
-      pq_dx_it[ v->id ] = pq_dx.push( v );
-    }
-    else
-    {
-      assert( v->id < (int)pq_dy_it.size( ) );
-      pq_dy_it[ v->id ] = pq_dy.push( v );
-    }
-  }
-  inline bool emptyPBheap( DL_sssp_direction go )
-  {
-    return ( go == DL_sssp_forward ) ? pq_dx.empty ( ) 
-				     : pq_dy.empty( ) ;
-  }
-
-  inline DLVertex<T> * topPBheap( DL_sssp_direction go )
-  {
-    return ( go == DL_sssp_forward ) ? pq_dx.top( ) 
-				     : pq_dy.top( );
-  }
-
-  inline void popPBheap( DL_sssp_direction go )
-  {
-    (go == DL_sssp_forward ) ? pq_dx.pop( ) : pq_dy.pop( );
-  }
-
-  inline void modifyPBheap( DL_sssp_direction go, DLVertex<T> * v )
-  {
-    ( go == DL_sssp_forward ) ? pq_dx.modify( pq_dx_it[ v->id ], v ) 
-			      : pq_dy.modify( pq_dy_it[ v->id ], v );
-  }
-
-  inline void clearPBheap ( DL_sssp_direction go )
-  {
-    ( go == DL_sssp_forward ) ? pq_dx.clear( ) : pq_dy.clear( );
-  }
-    
-  inline size_t sizePBheap( DL_sssp_direction go )
-  {
-    return ( go == DL_sssp_forward ) ? pq_dx.size( ) : pq_dy.size( );
-  }
+  inline DLVertexHeap<T> & ssspHeap( DL_sssp_direction go ) { return ( go == DL_sssp_forward ) ? dx_heap : dy_heap; }
 
   inline void addToNewSpaths( int i, int j )
   {
@@ -663,13 +699,13 @@ private:
   vector< int > dfs_finished;	     // Fast check if processing of vertex is finished
   int		dfs_finished_count;  // dfs finished count
 
-  bool			  active_apsp_inf; // To prevent nested usage
-  vector< vector< int > > apsp_infs;       // Fast check if a value in apsp matrix is infinity
-  int			  apsp_inf_count;  // Apsp infinity check token
-
 
-  Enode2Vertex          vertexMap;
-  Enode2Edge            edgeMap;
+  // Vertices and edges are allocated in chunks, that keep their addresses
+  std::deque< DLVertex<T> > vertex_pool;
+  std::deque< DLEdge<T> >   edge_pool;
+  vector< int >             enode_vertex; // Enode id -> vertex id, -1 if none
+  int                       zero_vertex;  // Vertex id of the zero variable, -1 if none
+  vector< DLComplEdges<T> > atom_edges;   // Edges of each atom, indexed by the atom slot
   vector< AdjList >     sAdj;	   // adjacency list - static constraint graph
   vector< DLEdge<T> * > sEdges;    // edges - static constraint graph
 
@@ -687,17 +723,14 @@ private:
   vector< DLEdge<T> * > conflict_edges;	// used to explain a conflict
   DLVertex<T> *         negCycleVertex;
 
-  vector< DLVertex<T> * > vertex_heap;
+  vector< DLVertex<T> * > vertex_heap;      // min-heap on gamma, used by checkNegCycle_
+  vector< int >           gamma_heap_pos;   // position of a vertex in vertex_heap, -1 if not there
   vector< DLVertex<T> * > changed_vertices;
 
   // data structures used in SSSP computations
   vector< DLVertex<T> * > dist_heap;    // min-heap of distances
-  typedef priority_queue< DLVertex<T> *, typename DLVertex<T>::ssspDxGreaterThan, pairing_heap_tag > pq_dx_type;
-  pq_dx_type pq_dx;
-  vector< typename pq_dx_type::point_iterator > pq_dx_it;
-  typedef priority_queue< DLVertex<T> *, typename DLVertex<T>::ssspDyGreaterThan, pairing_heap_tag > pq_dy_type;
-  pq_dy_type pq_dy;
-  vector< typename pq_dy_type::point_iterator > pq_dy_it;
+  DLVertexHeap< T > dx_heap;          // radix heap for long, 4-ary heap otherwise
+  DLVertexHeap< T > dy_heap;
 
   // data structures used in APSP computations
   set< DLTwoVertices<T>, typename DLTwoVertices<T>::vertexIdGreaterThan > new_spaths;	  // new shortest paths
@@ -713,6 +746,28 @@ private:
   vector< DLVertex<T> * > dx_relevant_vertices;
   vector< DLVertex<T> * > dy_relevant_vertices;
 
+  // A heavy edge waiting to be deduced
+  struct DLCandidate
+  {
+    double      activity;
+    T           rpath_wt;
+    DLEdge<T> * e;
+    // Most active first
+    inline bool operator<( const DLCandidate & o ) const { return activity > o.activity; }
+  };
+  vector< DLCandidate >   candidates;
+
+  // Paths with the fewest edges, layer by layer
+  struct DLHopEntry
+  {
+    DLVertex<T> * x;
+    T             dist;                  // Weight of the path to x
+    DLEdge<T> *   pred;                  // Last edge of the path
+    int           prev;                  // Entry of pred->u in the previous layer
+  };
+  vector< DLHopEntry >    hop_entries;
+  vector< int >           hop_best;      // Best entry for each vertex, -1 if none
+
   // for dfs
   vector< DLVertex<T> * > dfs_stack;
   vector< DLEdge<T> * > cycle_edges;
@@ -731,13 +786,52 @@ private:
 
   vector< Enode * > ne_stack;            // Negated equalities stack
   vector< size_t >  ne_stack_backtrack;  // Ne backtrack stack
+  vector< Enode * > ne_open;             // Negated equalities not decided by the equalities
+
+  //
+  // Classes of vertices whose difference is fixed by the
+  // positive equalities (only when equalities are not split)
+  //
+  inline void ufGrow( )
+  {
+    while ( uf_parent.size( ) < Vcnt )
+    {
+      uf_parent.push_back( uf_parent.size( ) );
+      uf_rank  .push_back( 0 );
+      uf_offset.push_back( T( 0 ) );
+      uf_reason.push_back( NULL );
+    }
+  }
+  // Returns the root of x and in d the difference delta( x -> root )
+  inline int ufFind( int x, T & d )
+  {
+    assert( x < (int)uf_parent.size( ) );
+    d = 0;
+    while ( uf_parent[ x ] != x )
+    {
+      d += uf_offset[ x ];
+      x = uf_parent[ x ];
+    }
+    return x;
+  }
+  void ufMerge  ( Enode * );
+  void ufExplain( int, int, vector< Enode * > & );
+
+  vector< int >               uf_parent;
+  vector< int >               uf_rank;
+  vector< T >                 uf_offset;   // delta( x -> parent ), the weight of any path from x to its parent
+  vector< Enode * >           uf_reason;   // Equality that merged x into its parent
+  vector< pair< int, bool > > uf_trail;    // Roots merged, and whether the rank of the new root was increased
+  vector< size_t >            uf_trail_lim;
+  vector< int >               uf_path;
 
 #ifdef PRODUCE_PROOF
   Enode * interpolants;
 #endif
 
-  Config & config;
-  Egraph & egraph;
+  Config &  config;
+  Egraph &  egraph;
+  const int solver_id;                   // Owner of the atom slots
 };
 
 #endif
@@ -0,0 +1,251 @@
+/*********************************************************************
+OpenSMT -- Copyright (C) 2008-2010, Roberto Bruttomesso
+
+OpenSMT is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+OpenSMT is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with OpenSMT. If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+
+// Priority queues of vertices for the SSSP computations of DLGraph
+#ifndef DLHEAP_H
+#define DLHEAP_H
+
+#include "Global.h"
+
+template <class T> struct DLVertex;
+
+// V is only a parameter so that the specialization for long
+// below can be declared before DLVertex is complete
+
+//
+// Generic version: 4-ary min-heap on the distance (dx for the
+// forward direction, dy for the backward one), with the position
+// of each vertex to support decrease key
+//
+template< class T, class V = DLVertex<T> > class DLVertexHeap
+{
+public:
+
+  DLVertexHeap( const bool forward_ ) : forward( forward_ ) { }
+
+  inline void          resize  ( size_t n )        { pos.resize( n, -1 ); }
+  inline bool          empty   ( )                 { return heap.empty( ); }
+  inline DLVertex<T> * top     ( )                 { assert( !heap.empty( ) ); return heap.front( ); }
+  inline bool          contains( DLVertex<T> * v ) { assert( v->id < (int)pos.size( ) ); return pos[ v->id ] >= 0; }
+
+  inline void push( DLVertex<T> * v )
+  {
+    assert( !contains( v ) );
+    heap.push_back( v );
+    siftUp( heap.size( ) - 1 );
+  }
+
+  inline void decrease( DLVertex<T> * v )
+  {
+    assert( contains( v ) );
+    siftUp( pos[ v->id ] );
+  }
+
+  inline void pop( )
+  {
+    assert( !heap.empty( ) );
+    pos[ heap.front( )->id ] = -1;
+    DLVertex<T> * last = heap.back( );
+    heap.pop_back( );
+    if ( heap.empty( ) )
+      return;
+    heap[ 0 ] = last;
+    siftDown( 0 );
+  }
+
+  inline void clear( )
+  {
+    for ( size_t i = 0 ; i < heap.size( ) ; i ++ )
+      pos[ heap[ i ]->id ] = -1;
+    heap.clear( );
+  }
+
+private:
+
+  static const int D = 4;
+
+  inline const T & key( DLVertex<T> * v ) { return forward ? v->dx : v->dy; }
+
+  void siftUp( int i )
+  {
+    DLVertex<T> * x = heap[ i ];
+    while ( i > 0 )
+    {
+      const int p = ( i - 1 ) / D;
+      if ( !( key( x ) < key( heap[ p ] ) ) )
+	break;
+      heap[ i ] = heap[ p ];
+      pos[ heap[ i ]->id ] = i;
+      i = p;
+    }
+    heap[ i ] = x;
+    pos[ x->id ] = i;
+  }
+
+  void siftDown( int i )
+  {
+    DLVertex<T> * x = heap[ i ];
+    const int n = heap.size( );
+    for ( ;; )
+    {
+      const int first = D * i + 1;
+      if ( first >= n )
+	break;
+      const int last = first + D < n ? first + D : n;
+      int c = first;
+      for ( int j = first + 1 ; j < last ; j ++ )
+	if ( key( heap[ j ] ) < key( heap[ c ] ) )
+	  c = j;
+      if ( !( key( heap[ c ] ) < key( x ) ) )
+	break;
+      heap[ i ] = heap[ c ];
+      pos[ heap[ i ]->id ] = i;
+      i = c;
+    }
+    heap[ i ] = x;
+    pos[ x->id ] = i;
+  }
+
+  const bool              forward;
+  vector< DLVertex<T> * > heap;
+  vector< int >           pos;      // Position in heap, -1 if not there
+};
+
+//
+// Integer distances: radix heap. Dijkstra pops non decreasing
+// keys, so a key only needs the bucket given by its highest bit
+// that differs from the last key popped. Decrease key pushes a
+// new entry, the old ones are skipped as stale when they surface
+//
+template< class V > class DLVertexHeap< long, V >
+{
+public:
+
+  DLVertexHeap( const bool forward_ ) : forward( forward_ ), last( 0 ) { }
+
+  inline void resize  ( size_t n ) { queued.resize( n, 0 ); }
+  inline bool empty   ( )          { return !normalize( ); }
+  inline V *  top     ( )          { normalize( ); assert( !buckets[ 0 ].empty( ) ); return buckets[ 0 ].back( ).second; }
+  inline bool contains( V * v )    { assert( v->id < (int)queued.size( ) ); return queued[ v->id ] != 0; }
+
+  inline void push( V * v )
+  {
+    assert( !contains( v ) );
+    queued[ v->id ] = 1;
+    insert( v );
+  }
+
+  inline void decrease( V * v )
+  {
+    assert( contains( v ) );
+    insert( v );
+  }
+
+  inline void pop( )
+  {
+    normalize( );
+    assert( !buckets[ 0 ].empty( ) );
+    queued[ buckets[ 0 ].back( ).second->id ] = 0;
+    buckets[ 0 ].pop_back( );
+  }
+
+  inline void clear( )
+  {
+    for ( int b = 0 ; b < BUCKETS ; b ++ )
+    {
+      for ( size_t i = 0 ; i < buckets[ b ].size( ) ; i ++ )
+	queued[ buckets[ b ][ i ].second->id ] = 0;
+      buckets[ b ].clear( );
+    }
+    last = 0;
+  }
+
+private:
+
+  static const int BUCKETS = sizeof( unsigned long ) * 8 + 1;
+
+  typedef pair< long, V * > Entry;
+
+  inline long key( V * v ) { return forward ? v->dx : v->dy; }
+
+  inline int bucketOf( long k )
+  {
+    assert( k >= last );
+    const unsigned long diff = static_cast< unsigned long >( k ) ^ static_cast< unsigned long >( last );
+    return diff == 0 ? 0 : BUCKETS - 1 - __builtin_clzl( diff );
+  }
+
+  inline void insert( V * v )
+  {
+    const long k = key( v );
+    assert( k >= 0 );
+    buckets[ bucketOf( k ) ].push_back( Entry( k, v ) );
+  }
+
+  inline bool isStale( const Entry & e ) { return !queued[ e.second->id ] || key( e.second ) != e.first; }
+
+  //
+  // Makes sure that the back of bucket 0 is a live entry with the
+  // minimum key, redistributing the first non empty bucket if needed.
+  // Returns false if the heap is empty
+  //
+  bool normalize( )
+  {
+    for ( ;; )
+    {
+      while ( !buckets[ 0 ].empty( ) && isStale( buckets[ 0 ].back( ) ) )
+	buckets[ 0 ].pop_back( );
+      if ( !buckets[ 0 ].empty( ) )
+	return true;
+
+      int b = 1;
+      while ( b < BUCKETS && buckets[ b ].empty( ) )
+	b ++;
+      if ( b == BUCKETS )
+	return false;
+
+      // New minimum, among the live entries
+      vector< Entry > & bucket = buckets[ b ];
+      bool found = false;
+      for ( size_t i = 0 ; i < bucket.size( ) ; i ++ )
+	if ( !isStale( bucket[ i ] ) && ( !found || bucket[ i ].first < last ) )
+	{
+	  last = bucket[ i ].first;
+	  found = true;
+	}
+
+      // All entries in the bucket are stale
+      if ( !found )
+      {
+	bucket.clear( );
+	continue;
+      }
+
+      for ( size_t i = 0 ; i < bucket.size( ) ; i ++ )
+	if ( !isStale( bucket[ i ] ) )
+	  buckets[ bucketOf( bucket[ i ].first ) ].push_back( bucket[ i ] );
+      bucket.clear( );
+    }
+  }
+
+  const bool      forward;
+  long            last;            // Last minimum
+  vector< Entry > buckets[ BUCKETS ];
+  vector< char >  queued;          // True if the vertex has a live entry
+};
+
+#endif
@@ -39,6 +39,11 @@ public:
 	  : OrdinaryTSolver ( i, n, c, e, t, x, d, s )
   {
     initGraph();
+#ifdef STATISTICS
+    propagations_done = 0;
+    deductions_sent = 0;
+    deductions_used = 0;
+#endif
   }
 
   ~DLSolver ( );
@@ -50,6 +55,7 @@ public:
   bool                check               ( bool );
   bool                belongsToT          ( Enode * );
   void                computeModel        ( );
+  lbool               evaluate            ( Enode * );
 #ifdef PRODUCE_PROOF
   Enode *             getInterpolants( logic_t & );
 #endif
@@ -67,6 +73,11 @@ private:
   DLGraph< T > *      G;                          // The graph
   vector< Enode * >   undo_stack_edges;		  // Keeps track of edges present in a graph
   vector< size_t  >   backtrack_points;		  // Keeps track of backtrack points
+#ifdef STATISTICS
+  long                propagations_done;          // Number of calls to findHeavyEdges
+  long                deductions_sent;            // Number of deductions sent
+  long                deductions_used;            // Number of deductions that came back as assignments
+#endif
 };
 
 #endif
@@ -0,0 +1,94 @@
+/*********************************************************************
+ OpenSMT -- Copyright (C) 2009, Roberto Bruttomesso
+
+ OpenSMT is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ OpenSMT is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with OpenSMT. If not, see <http://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LAFLOATTABLEAU_H
+#define LAFLOATTABLEAU_H
+
+#include "LAVar.h"
+
+//
+// Floating point mirror of the simplex tableau. It is used
+// to search for a good basis cheaply: the result is never
+// trusted, the exact tableau is moved to the basis found
+// here and certifies (or repairs) it with exact pivots
+//
+class LAFloatTableau
+{
+public:
+
+  LAFloatTableau( ) : pivots( 0 ), pivots_since_build( 0 ) { }
+
+  void build ( vector< LAVar * > &, vector< LAVar * > & ); // Copies the exact tableau, bounds and model
+  bool sync  ( vector< LAVar * > &, vector< LAVar * > & ); // Copies bounds and model only, false if the basis differs
+  bool solve ( unsigned );                                 // Runs the simplex, true if it terminated within the given pivots
+
+  inline bool isBasic       ( int c ) { return row_of[ c ] != -1; }
+  inline int  boundPosition ( int );                       // -1 if the column sits on its lower bound, 1 on the upper, 0 otherwise
+
+  unsigned pivots;                                         // Pivots done by the last solve
+  unsigned pivots_since_build;                             // Pivots done since the rows were copied, for the rounding errors
+
+private:
+
+  // Values with a symbolic delta part, as in Delta
+  struct FDelta
+  {
+    double r;
+    double d;
+  };
+
+  typedef vector< pair< int, double > > FRow;              // Sorted by column id
+
+  inline bool less        ( const FDelta &, const FDelta & );
+  inline bool outOfLower  ( int c ) { return has_l[ c ] && less( m[ c ], l[ c ] ); }
+  inline bool outOfUpper  ( int c ) { return has_u[ c ] && less( u[ c ], m[ c ] ); }
+  inline bool belowUpper  ( int c ) { return !has_u[ c ] || less( m[ c ], u[ c ] ); }
+  inline bool aboveLower  ( int c ) { return !has_l[ c ] || less( l[ c ], m[ c ] ); }
+  void        pivotAndUpdate ( int, int, double, const FDelta & ); // Pivots the basic of a row with a column and moves it to a value
+  void        fromDelta      ( const Delta &, FDelta & );
+  void        copyBounds     ( vector< LAVar * > & );      // Copies bounds and model of the columns
+
+  vector< FRow >   frows;                                  // Rows: basic = sum coef * nonbasic
+  vector< int >    basic_of;                               // Row index -> basic column
+  vector< int >    row_of;                                 // Column id -> row index, -1 if nonbasic
+  vector< FDelta > m, l, u;                                // Model and bounds per column id
+  vector< char >   has_l, has_u;                           // False for infinite bounds
+};
+
+int LAFloatTableau::boundPosition( int c )
+{
+  if ( has_l[ c ] && m[ c ].r == l[ c ].r && m[ c ].d == l[ c ].d )
+    return -1;
+  if ( has_u[ c ] && m[ c ].r == u[ c ].r && m[ c ].d == u[ c ].d )
+    return 1;
+  return 0;
+}
+
+//
+// Lexicographic comparison with a relative tolerance
+// on the main value, and an absolute one on the delta
+//
+bool LAFloatTableau::less( const FDelta & a, const FDelta & b )
+{
+  const double scale = 1.0 + ( a.r < 0 ? -a.r : a.r ) + ( b.r < 0 ? -b.r : b.r );
+  const double eps = 1e-9 * scale;
+  if ( a.r < b.r - eps ) return true;
+  if ( a.r > b.r + eps ) return false;
+  return a.d < b.d - 1e-9;
+}
+
+#endif
@@ -77,16 +77,17 @@ public:
   LAVar( Enode * e_orig, Enode * e_var, const Real & v, bool revert );        // Constructor with bounds from real
   virtual ~LAVar( );                                                    // Destructor
 
-  void setBounds( Enode * e, Enode * e_bound);          // Set the bounds from Enode of original constraint (used on reading/construction stage)
-  void setBounds( Enode * e, const Real & v, bool revert);   // Set the bounds according to enode type and a given value (used on reading/construction stage)
+  void setBounds( Enode * e, Enode * e_bound, vector< int > * remap = NULL );          // Set the bounds from Enode of original constraint (remap receives the new positions of the old bounds, if given)
+  void setBounds( Enode * e, const Real & v, bool revert, vector< int > * remap = NULL );   // Set the bounds according to enode type and a given value (remap as above)
 
   unsigned setUpperBound( const Real & v);
   unsigned setLowerBound( const Real & v);
 
   unsigned setBound( const Real & v, bool upper);
-  void addBoundsAndUpdateSorting(const LAVarBound & pb1, const LAVarBound & pb2);
+  void addBoundsAndUpdateSorting(const LAVarBound & pb1, const LAVarBound & pb2, vector< int > * remap = NULL);
   void addBoundAndUpdateSorting(const LAVarBound & pb);
-  void updateSorting();
+  void updateSorting( vector< int > * remap = NULL );
+  void removeBounds( Enode * e, vector< int > & remap );        // Remove the bounds read from e, remap receives the new positions of the others (-1 if removed)
 
   unsigned getBoundByValue( const Real & v, bool upper);
 
@@ -118,14 +119,19 @@ public:
   inline void saveModel( );                     // save model locally
   inline void restoreModel( );                  // restore to last globally saved model
   static inline void saveModelGlobal( );        // save model globally
+  static inline void setColumnCount( int c ) { column_count = c; } // rewind the column counter (when columns are removed)
+  static inline void setRowCount( int r ) { row_count = r; }       // rewind the row counter (when rows are removed)
   void computeModel( const Real& b = 0 );       // save the actual model to Egraph
 
   inline const Delta & U( ); // The latest upper bound of LAVar (+inf by default)
   inline const Delta & L( ); // The latest lower bound of LAVar (-inf by default)
   inline const Delta & M( ); // The latest model of LAVar (0 by default)
 
+  inline const Delta & savedM( ); // The model restoreModel would go back to
+
   inline void incM( const Delta &v ); // increase actual model by v
   inline void setM( const Delta &v ); //set actual model to v
+  inline void resetModel( const Delta &v, const Delta &saved ); // set actual model to v, and the one restoreModel goes back to
 
   // two operators for output
   inline friend ostream & operator <<( ostream & out, LAVar * v )
@@ -284,6 +290,11 @@ const Delta & LAVar::M( )
   return ( *m1 );
 }
 
+const Delta & LAVar::savedM( )
+{
+  return model_local_counter == model_global_counter ? ( *m2 ) : ( *m1 );
+}
+
 void LAVar::incM( const Delta &v )
 {
   setM( M( ) + v );
@@ -296,4 +307,11 @@ void LAVar::setM( const Delta &v )
   ( *m1 ) = v;
 }
 
+void LAVar::resetModel( const Delta &v, const Delta &saved )
+{
+  ( *m2 ) = saved;
+  model_local_counter = model_global_counter;
+  ( *m1 ) = v;
+}
+
 #endif
@@ -25,6 +25,7 @@
 #include "LAVar.h"
 #include "LARow.h"
 #include "LAColumn.h"
+#include "LAFloatTableau.h"
 
 //
 // Class to solve Linear Arithmetic theories
@@ -42,6 +43,15 @@ private:
     bool bound_type;
   };
 
+  // Feasible basis found for a set of bounds
+  struct BasisCacheEntry
+  {
+    vector< int >                basics;    // Basic column of each row
+    vector< pair< int, Delta > > nonbasics; // Values of the nonbasic columns
+    unsigned                     columns_n; // Number of columns when saved
+    unsigned                     pivots;    // Pivots spent by the check that found it
+  };
+
   // Possible internal states of the solver
   typedef enum
   {
@@ -63,6 +73,26 @@ public:
     status = INIT;
     checks_history.push_back(0);
     first_update_after_backtrack = true;
+    eliminated_from = 0;
+    tableau_version = 0;
+    float_tableau_version = 0;
+    bound_set_hash = 0;
+    bound_set_hash_valid = false;
+    cut_period = config.lra_cut_period > 1 ? config.lra_cut_period : 1;
+    branches_since_cut = 0;
+    fractional_at_last_cut = 0;
+#ifdef STATISTICS
+    branches_done = 0;
+    gomory_cuts_done = 0;
+    proof_splits_done = 0;
+    proof_conflicts_done = 0;
+    float_checks_done = 0;
+    float_pivots_done = 0;
+    exact_pivots_done = 0;
+    basis_cache_lookups = 0;
+    basis_cache_hits = 0;
+    basis_pivots_saved = 0;
+#endif
   }
 
   ~LRASolver( );                                      // Destructor ;-)
@@ -72,6 +102,9 @@ public:
   bool  assertLit          ( Enode *, bool = false ); // Push the constraint into Solver
   void  pushBacktrackPoint ( );                       // Push a backtrack point
   void  popBacktrackPoint  ( );                       // Backtrack to last saved point
+  void  pushScope          ( );                       // Push an incremental scope
+  void  popScope           ( );                       // Remove the rows, columns and bounds informed in the last scope
+  bool  hasScopes          ( ) { return true; }
   bool  belongsToT         ( Enode * );               // Checks if Atom belongs to this theory
   void  computeModel       ( );                       // Computes the model into enodes
 
@@ -90,7 +123,12 @@ protected:
 
 private:
 
-  void        doGaussianElimination           ( );				   // Performs Gaussian elimination of all redundant terms in the Tableau
+  void        doGaussianElimination           ( unsigned );			   // Performs Gaussian elimination of the redundant terms in the Tableau, starting from a column
+  void        restoreEliminated               ( LAVar * );                         // Puts back in the Tableau a column removed by Gaussian elimination
+  void        remapHistory                    ( LAVar *, const vector< int > & );  // Moves the bound positions saved in the history after the bounds of a column changed
+  void        setRowModel                     ( LAVar * );                         // Computes the model of a basic variable from its row
+  void        dropRow                         ( LAVar * );                         // Removes the row of a basic variable from the Tableau
+  void        moveLastRowTo                   ( int );                             // Moves the last row of the Tableau to a free slot
   void        update                          ( LAVar *, const Delta & );	   // Updates the bounds after constraint pushing
   void        pivotAndUpdate                  ( LAVar *, LAVar *, const Delta & ); // Updates the tableau after constraint pushing
   void        getConflictingBounds            ( LAVar *, vector<Enode *> & );      // Returns the bounds conflicting with the actual model
@@ -98,9 +136,20 @@ private:
   inline bool getStatus                       ( );                                 // Read the status of the solver in lbool
   inline bool setStatus                       ( LRASolverStatus );                 // Sets and return status of the solver
   void        initSolver                      ( );                                 // Initializes the solver
+  void        floatSimplex                    ( );                                 // Searches a basis in floating point and moves the exact tableau to it
+  bool        loadCachedBasis                 ( );                                 // Moves the tableau to the basis cached for the current bounds
+  void        saveBasis                       ( unsigned );                        // Caches the current (feasible) basis for the current bounds
+  void        clearBasisCache                 ( );                                 // Forgets the cached bases, when the tableau changes
+  void        rehashBounds                    ( );                                 // Recomputes the hash of the active bounds
+  inline uint64_t boundHash                   ( LAVar *, unsigned, bool );         // Hash of a single active bound, 0 for infinite ones
   void        print                           ( ostream & out );                   // Prints terms, current bounds and the tableau
   void        addVarToRow                     ( LAVar*, LAVar*, Real*);            //
   bool        checkIntegersAndSplit           ( );                                 //
+  bool        getGomoryCut                    ( LAVar *, vector<Enode *> & );      // Computes a Gomory mixed-integer cut from the row of a basic variable
+  bool        getLatticeSplit                 ( LAVar *, vector<Enode *> & );      // Cuts from proofs: gcd test on the row of a basic variable
+  void        getSplittingClause              ( LAVar *, const Real &, const Real &, vector<Enode *> & ); // Builds the clause x <= lo v x >= hi
+  void        getBoundsConflict               ( LAVar * );                         // Explains that no integer value fits the bounds of a variable
+  inline bool isIntegerVar                    ( LAVar * v ) { return v->e->isVar( ) && v->e->hasSortInt( ); }
 
 #ifdef PRODUCE_PROOF
   Enode *     getInterpolants                 ( logic_t & );                       // Fill a vector with interpolants
@@ -115,6 +164,36 @@ private:
   set< LAVar * >         touched_rows;                     // Keeps the set of modified rows
 
   vector < LAVar * > removed_by_GaussianElimination;       // Stack of variables removed during Gaussian elimination
+  unsigned           eliminated_from;                      // Columns from this one on were never considered for elimination
+
+  vector< Enode * >      informed_atoms;                   // Atoms informed, in order (incremental only)
+  vector< unsigned >     scope_columns;                    // Number of columns at each incremental scope
+  vector< unsigned >     scope_atoms;                      // Number of informed atoms at each incremental scope
+
+  LAFloatTableau         float_tableau;                    // Floating point mirror of the tableau
+  unsigned               tableau_version;                  // Bumped when rows or columns are added or removed, not on pivots
+  unsigned               float_tableau_version;            // Value of tableau_version when the mirror was built
+
+  map< uint64_t, BasisCacheEntry > basis_cache;            // Feasible bases by hash of the active bounds
+  list< uint64_t >       basis_cache_order;                // Insertion order of the cache, for eviction
+  uint64_t               bound_set_hash;                   // Hash of the active bounds, kept up to date on assert and backtrack
+  bool                   bound_set_hash_valid;             // False when bound indexes changed and a rehash is needed
+
+  unsigned               cut_period;                       // Number of branches to perform before the next round of cuts
+  unsigned               branches_since_cut;               // Branches performed since the last round of cuts
+  unsigned               fractional_at_last_cut;           // Number of non integer columns seen at the last round of cuts
+#ifdef STATISTICS
+  int                    branches_done;                    // Number of branch and bound splits
+  int                    gomory_cuts_done;                 // Number of Gomory cuts
+  int                    proof_splits_done;                // Number of splits on gcd lattices
+  int                    proof_conflicts_done;             // Number of conflicts found by the gcd test
+  int                    float_checks_done;                // Number of checks that ran the floating point simplex
+  int                    float_pivots_done;                // Number of floating point pivots
+  int                    exact_pivots_done;                // Number of exact pivots
+  int                    basis_cache_lookups;              // Number of basis cache lookups
+  int                    basis_cache_hits;                 // Number of bases restored from the cache
+  long                   basis_pivots_saved;               // Estimate of the pivots saved by the cache
+#endif
 
   // Two reloaded output operators
   inline friend ostream & operator <<( ostream & out, LRASolver & solver )
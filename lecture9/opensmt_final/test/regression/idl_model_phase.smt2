@@ -0,0 +1,23 @@
+(set-option :print-success false)
+(set-logic QF_IDL)
+; Decision phases from the DL potential: the boolean
+; variable p has no theory atom and used to crash the
+; phase lookup
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun p () Bool)
+(declare-fun q () Bool)
+(assert (or p (<= (- x y) 3)))
+(check-sat)
+(assert (or (not p) q (<= (- y z) (- 2))))
+(assert (or (not q) (<= (- z x) 1)))
+(check-sat)
+(push 1)
+(assert (<= (- y x) (- 4)))
+(assert (<= (- z y) 1))
+(assert (not p))
+(check-sat)
+(pop 1)
+(assert (or (<= (- x z) (- 1)) (and q (<= (- z y) 0))))
+(check-sat)
@@ -0,0 +1,31 @@
+(set-option :print-success false)
+(set-logic QF_LRA)
+; Integer solver on integer variables, with branches only,
+; with Gomory cuts and with cuts from proofs. The atoms of
+; the splits are informed during the search, and used to
+; break the position of the bounds already asserted
+(declare-fun x0 () Int)
+(declare-fun x1 () Int)
+(declare-fun x2 () Int)
+(declare-fun x3 () Int)
+(assert (<= x0 6))
+(assert (<= (- x3) 6))
+(assert (not (<= (+ x1 (* 2 x0)) 12)))
+(assert (or (not (<= (- x1) (- 2))) (<= (+ (* 2 x1) x3) (- 5))))
+(assert (or (<= (+ (* (- 3) x1) (* 5 x2)) 8) (not (<= (+ (* 2 x1) (* 5 x2)) (- 10)))))
+(check-sat)
+(push 1)
+; No multiple of 2 is 13
+(assert (<= (+ (* 2 x2) (* 2 x3)) 13))
+(assert (>= (+ (* 2 x2) (* 2 x3)) 13))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (<= (+ (* 3 x2) (* 2 x3)) 8))
+(assert (>= (+ (* 3 x2) (* (- 2) x3)) 2))
+(assert (>= x3 1))
+(check-sat)
+(assert (<= x2 1))
+(check-sat)
+(pop 1)
+(check-sat)
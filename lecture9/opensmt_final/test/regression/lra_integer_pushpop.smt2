@@ -0,0 +1,19 @@
+(set-option :print-success false)
+(set-logic QF_LRA)
+; The same integer split is needed in two scopes. It used
+; to be filtered as a duplicate after the first pop
+(declare-fun x () Int)
+(declare-fun y () Int)
+(push 1)
+(assert (<= (+ (* 3 x) (* 2 y)) 7))
+(assert (>= (+ (* 3 x) (* (- 2) y)) 2))
+(assert (>= y 1))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (<= (+ (* 3 x) (* 2 y)) 7))
+(assert (>= (+ (* 3 x) (* (- 2) y)) 2))
+(assert (>= y 1))
+(check-sat)
+(pop 1)
+(check-sat)
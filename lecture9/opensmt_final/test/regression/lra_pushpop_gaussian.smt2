@@ -0,0 +1,19 @@
+(set-option :print-success false)
+(set-logic QF_LRA)
+; Gaussian elimination with incremental scopes: the last check
+; used to answer sat, with x0 = x3 = 0 violating x0 + x3 >= 6
+(declare-fun x0 () Real)
+(declare-fun x3 () Real)
+(declare-fun x4 () Real)
+(declare-fun x5 () Real)
+(assert (or (<= (+ (* (- 2) x4) (* 3 x3) (* 1 x5)) (- 1)) (not (<= (* (- 1) x4) 3))))
+(assert (<= (+ (* (- 1) x3) (* (- 1) x0)) (- 6)))
+(check-sat)
+(assert (not (<= (* (- 3) x3) (- 9))))
+(assert (<= x0 1))
+(check-sat)
+(assert (<= (+ (* (- 1) x3) (* (- 2) x0)) 5))
+(push 1)(push 1)(push 1)(pop 1)(pop 1)
+(check-sat)(check-sat)
+(pop 1)(push 1)
+(check-sat)
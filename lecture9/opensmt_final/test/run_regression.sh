@@ -0,0 +1,35 @@
+#!/bin/sh
+#
+# Runs every script in test/regression and compares the
+# answers with the matching .expected file. A script with
+# configuration files <script>.<name>.cfg is run once with
+# each of them instead of once with the defaults
+#
+srcdir=${srcdir:-.}
+opensmt=${OPENSMT:-./opensmt}
+failed=0
+
+for f in $srcdir/test/regression/*.smt2
+do
+  configs=`ls $f.*.cfg 2> /dev/null`
+  for c in ${configs:-default}
+  do
+    if [ "$c" = default ]
+    then
+      options=
+      name=$f
+    else
+      options=--config=$c
+      name="$f with $c"
+    fi
+    if $opensmt $options $f 2>/dev/null | diff - $f.expected > /dev/null
+    then
+      echo "PASS: $name"
+    else
+      echo "FAIL: $name"
+      failed=1
+    fi
+  done
+done
+
+exit $failed